@@ -1,7 +1,20 @@
 #ifndef MS_ARBITRARY_DIM_ARRAY
 #define MS_ARBITRARY_DIM_ARRAY
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Arrays of at least this many bytes are filled with non-temporal stores that bypass the cache.
+// Should be about the size of the last level cache; define before including to override.
+#ifndef MS_ARRAY_STREAMING_THRESHOLD
+#define MS_ARRAY_STREAMING_THRESHOLD (32u << 20)
+#endif
 
 namespace ms {
 
@@ -15,6 +28,79 @@ namespace ms {
         }
     };
 
+    /*
+     * Tag type selecting the constructor that leaves the elements uninitialized
+     */
+    struct Uninitialized_Tag {};
+    constexpr Uninitialized_Tag uninitialized{};
+
+    namespace detail {
+
+#if defined(__SSE2__)
+        // Fills count elements at dst with value using 16-byte non-temporal stores
+        template<typename T>
+        void stream_fill_n(T *dst, std::size_t count, const T &value) {
+            // Scalar stores until dst is 16-byte aligned
+            while (count > 0 && reinterpret_cast<std::uintptr_t>(dst) % 16 != 0) {
+                *dst++ = value;
+                --count;
+            }
+
+            // Broadcast value into one vector register
+            alignas(16) T pattern[16 / sizeof(T)];
+            std::fill_n(pattern, 16 / sizeof(T), value);
+            const __m128i vector = _mm_load_si128(reinterpret_cast<const __m128i *>(pattern));
+
+            __m128i *out = reinterpret_cast<__m128i *>(dst);
+            std::size_t vectors = count * sizeof(T) / 16;
+            std::size_t index = 0;
+            for (; index + 4 <= vectors; index += 4) {
+                _mm_stream_si128(out + index, vector);
+                _mm_stream_si128(out + index + 1, vector);
+                _mm_stream_si128(out + index + 2, vector);
+                _mm_stream_si128(out + index + 3, vector);
+            }
+            for (; index < vectors; ++index) {
+                _mm_stream_si128(out + index, vector);
+            }
+            _mm_sfence();
+
+            // Scalar stores for the remaining tail
+            std::size_t done = vectors * 16 / sizeof(T);
+            std::fill_n(dst + done, count - done, value);
+        }
+#endif
+
+        // Element types stream_fill_n supports: arithmetic types that tile a 16-byte vector exactly
+        template<typename T>
+        struct Is_Streamable : std::integral_constant<bool, std::is_arithmetic<T>::value && 16 % sizeof(T) == 0> {};
+
+        // Fill kernel for element types without a streaming path
+        template<typename T>
+        void fill_n(T *dst, std::size_t count, const T &value, std::false_type) {
+            std::fill_n(dst, count, value);
+        }
+
+        // Fill kernel for streamable element types, using non-temporal stores above MS_ARRAY_STREAMING_THRESHOLD
+        template<typename T>
+        void fill_n(T *dst, std::size_t count, const T &value, std::true_type) {
+#if defined(__SSE2__)
+            if (count * sizeof(T) >= MS_ARRAY_STREAMING_THRESHOLD) {
+                stream_fill_n(dst, count, value);
+                return;
+            }
+#endif
+            std::fill_n(dst, count, value);
+        }
+
+        // Fills count elements at dst with value. The kernel is chosen at compile time from the element type;
+        // everything below the streaming threshold uses std::fill_n (which the compiler vectorizes).
+        template<typename T>
+        void fill_n(T *dst, std::size_t count, const T &value) {
+            fill_n(dst, count, value, Is_Streamable<T>());
+        }
+    }
+
     // Basic declaration for template multidimensional Array class
     template<typename T, std::size_t... Dims>
     class Array;
@@ -27,21 +113,25 @@ namespace ms {
         static_assert(Dim > 0, "Array cannot be created with less than zero dimension.");
 
         // Default constructor must be defined, either explicitly or implicitly.
-        Array() : _array_size{Dim} {}
+        // Defaulted so the array is trivially default-constructible whenever T is.
+        Array() = default;
+
+        // Constructor leaving the elements uninitialized, even when the array is value-initialized.
+        explicit Array(Uninitialized_Tag) {}
 
         // Copy constructor. The dimensionality of the source array must be the same.
-        Array(const Array &array) : _array_size{Dim} {
+        Array(const Array &array) {
             // Copy the elements from array to this->_array
-            for (int index = 0; index < _array_size; ++index) {
+            for (std::size_t index = 0; index < _array_size; ++index) {
                 _array[index] = array[index];
             }
         }
 
         // Template copy constructor. The dimensionality of the source array must be the same.
         template<typename U>
-        Array(const Array<U, Dim, Dims...> &array) : _array_size{Dim} {
+        Array(const Array<U, Dim, Dims...> &array) {
             // Copy the elements from array to this->_array
-            for (int index = 0; index < _array_size; ++index) {
+            for (std::size_t index = 0; index < _array_size; ++index) {
                 _array[index] = array[index];
             }
         }
@@ -106,6 +196,28 @@ namespace ms {
             return _array[index];
         }
 
+        // Returns a pointer to the first element. All elements are stored contiguously in row-major order.
+        // Nested arrays hold nothing but their elements, so the whole object is one T[_total_size] block.
+        T *data() {
+            static_assert(sizeof(Array) == _total_size * sizeof(T), "Array elements must be stored contiguously.");
+            return reinterpret_cast<T *>(this);
+        }
+
+        const T *data() const {
+            static_assert(sizeof(Array) == _total_size * sizeof(T), "Array elements must be stored contiguously.");
+            return reinterpret_cast<const T *>(this);
+        }
+
+        // Assigns value to every element
+        void fill(const T &value) {
+            detail::fill_n(data(), _total_size, value);
+        }
+
+        // Assigns a value-initialized T (zero for arithmetic types) to every element
+        void zero() {
+            detail::fill_n(data(), _total_size, T());
+        }
+
         /*
          * Nested class used to iterate through the array in row-major order.
          * This iterator can be be used to read or write from the array.
@@ -176,7 +288,7 @@ namespace ms {
             // Returns a reference to the T at this position in the array.
             T &operator*() const {
                 // Recursive call to dereference operator of nested iterators
-                *_arr_rec_iter;
+                return *_arr_rec_iter;
             }
 
         public:
@@ -254,7 +366,7 @@ namespace ms {
             // Returns a reference to the T at this position in the array.
             T &operator*() const {
                 // Recursive call to dereference operator of nested iterators
-                *_arr_rec_iter;
+                return *_arr_rec_iter;
             }
 
         public:
@@ -337,7 +449,8 @@ namespace ms {
          */
         static T ValueType;             // Member to indicate the data type of the array
         Array<T, Dims...> _array[Dim];  // Member to represent array of Array<T, Dims...> type
-        std::size_t _array_size;        // Member to hold size of the member array
+        static constexpr std::size_t _array_size = Dim;                                 // Size of the member array
+        static constexpr std::size_t _total_size = Dim * Array<T, Dims...>::_total_size; // Number of T elements
     };
 
     // Base Case for template multidimensional Array class
@@ -348,10 +461,14 @@ namespace ms {
         static_assert(Dim > 0, "Array cannot be created with less than zero dimension.");
 
         // Default constructor must be defined, either explicitly or implicitly.
-        Array() : _array_size{Dim} {}
+        // Defaulted so the array is trivially default-constructible whenever T is.
+        Array() = default;
+
+        // Constructor leaving the elements uninitialized, even when the array is value-initialized.
+        explicit Array(Uninitialized_Tag) {}
 
         // Copy constructor. The dimensionality of the source array must be the same.
-        Array(const Array &array) : _array_size{Dim} {
+        Array(const Array &array) {
             // Copy the elements from array to this->_array
             for (std::size_t index = 0; index < _array_size; ++index) {
                 _array[index] = array[index];
@@ -360,7 +477,7 @@ namespace ms {
 
         // Template copy constructor. The dimensionality of the source array must be the same.
         template<typename U>
-        Array(const Array<U, Dim> &array) : _array_size{Dim} {
+        Array(const Array<U, Dim> &array) {
             // Copy the elements from array to this->_array
             for (std::size_t index = 0; index < _array_size; ++index) {
                 _array[index] = array[index];
@@ -426,6 +543,25 @@ namespace ms {
             return _array[index];
         }
 
+        // Returns a pointer to the first element. All elements are stored contiguously in row-major order.
+        T *data() {
+            return _array;
+        }
+
+        const T *data() const {
+            return _array;
+        }
+
+        // Assigns value to every element
+        void fill(const T &value) {
+            detail::fill_n(data(), _total_size, value);
+        }
+
+        // Assigns a value-initialized T (zero for arithmetic types) to every element
+        void zero() {
+            detail::fill_n(data(), _total_size, T());
+        }
+
         /*
          * Nested class used to iterate through the array in row-major order.
          * This iterator can be be used to read or write from the array.
@@ -647,7 +783,8 @@ namespace ms {
          */
         static T ValueType;         // Member to indicate the data type of the array
         T _array[Dim];              // Member to represent array of Array<T, Dims...> type
-        std::size_t _array_size;    // Member to hold size of the member array
+        static constexpr std::size_t _array_size = Dim;    // Size of the member array
+        static constexpr std::size_t _total_size = Dim;    // Number of T elements
     };
 }
 
@@ -0,0 +1,383 @@
+#ifndef MS_ARRAY_SCAN
+#define MS_ARRAY_SCAN
+
+#include "arbitrary_dim_array.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Scans over arrays with fewer elements than this run on the calling thread only; define before including to override.
+#ifndef MS_ARRAY_SCAN_PARALLEL_THRESHOLD
+#define MS_ARRAY_SCAN_PARALLEL_THRESHOLD (1u << 16)
+#endif
+
+namespace ms {
+
+    namespace detail {
+
+        /*
+         * Layout of a scan along one axis of a row-major array: outer independent lines, each holding
+         * length rows of inner contiguous elements. Row k of line o starts at (o * length + k) * inner.
+         */
+        struct Scan_Shape {
+            std::size_t outer;    // Product of the dimensions before the axis
+            std::size_t length;   // Dimension of the axis
+            std::size_t inner;    // Product of the dimensions after the axis
+        };
+
+        // Computes the scan layout of axis for an array of the given dimensions
+        template<std::size_t... Dims>
+        Scan_Shape scan_shape(std::size_t axis) {
+            const std::size_t dims[] = {Dims...};
+
+            // Throw exception if axis is greater than the rank of the array
+            if (axis >= sizeof...(Dims)) {
+                throw Out_Of_Range_Exception();
+            }
+
+            Scan_Shape shape = {1, dims[axis], 1};
+            for (std::size_t index = 0; index < axis; ++index) {
+                shape.outer *= dims[index];
+            }
+            for (std::size_t index = axis + 1; index < sizeof...(Dims); ++index) {
+                shape.inner *= dims[index];
+            }
+            return shape;
+        }
+
+        // Inclusive scan of one contiguous row
+        template<typename T, typename BinaryOp>
+        void scan_row(T *row, std::size_t length, BinaryOp op) {
+            for (std::size_t index = 1; index < length; ++index) {
+                row[index] = op(row[index - 1], row[index]);
+            }
+        }
+
+#if defined(__SSE2__)
+        /*
+         * In-register prefix sums of contiguous rows. Each vector is scanned with log2(lanes) shift-and-add
+         * steps and then offset by the broadcast last lane of the previous vector.
+         */
+        inline void scan_row(std::int32_t *row, std::size_t length, std::plus<std::int32_t>) {
+            __m128i carry = _mm_setzero_si128();
+            std::size_t index = 0;
+            for (; index + 4 <= length; index += 4) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + index));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+                x = _mm_add_epi32(x, carry);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(row + index), x);
+                carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            for (index = std::max<std::size_t>(index, 1); index < length; ++index) {
+                row[index] += row[index - 1];
+            }
+        }
+
+        inline void scan_row(std::int64_t *row, std::size_t length, std::plus<std::int64_t>) {
+            __m128i carry = _mm_setzero_si128();
+            std::size_t index = 0;
+            for (; index + 2 <= length; index += 2) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + index));
+                x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+                x = _mm_add_epi64(x, carry);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(row + index), x);
+                carry = _mm_unpackhi_epi64(x, x);
+            }
+            for (index = std::max<std::size_t>(index, 1); index < length; ++index) {
+                row[index] += row[index - 1];
+            }
+        }
+
+        inline void scan_row(float *row, std::size_t length, std::plus<float>) {
+            __m128 carry = _mm_setzero_ps();
+            std::size_t index = 0;
+            for (; index + 4 <= length; index += 4) {
+                __m128 x = _mm_loadu_ps(row + index);
+                x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+                x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+                x = _mm_add_ps(x, carry);
+                _mm_storeu_ps(row + index, x);
+                carry = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            for (index = std::max<std::size_t>(index, 1); index < length; ++index) {
+                row[index] += row[index - 1];
+            }
+        }
+
+        inline void scan_row(double *row, std::size_t length, std::plus<double>) {
+            __m128d carry = _mm_setzero_pd();
+            std::size_t index = 0;
+            for (; index + 2 <= length; index += 2) {
+                __m128d x = _mm_loadu_pd(row + index);
+                x = _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+                x = _mm_add_pd(x, carry);
+                _mm_storeu_pd(row + index, x);
+                carry = _mm_unpackhi_pd(x, x);
+            }
+            for (index = std::max<std::size_t>(index, 1); index < length; ++index) {
+                row[index] += row[index - 1];
+            }
+        }
+#endif
+
+        // Inclusive scan of rows [begin, end) of one line, ignoring the rows before begin
+        template<typename T, typename BinaryOp>
+        void scan_block(T *line, std::size_t begin, std::size_t end, std::size_t inner, BinaryOp op) {
+            // Contiguous axis, scan inside the row
+            if (inner == 1) {
+                scan_row(line + begin, end - begin, op);
+                return;
+            }
+
+            // Outer axis, combine whole rows so the inner loop runs over contiguous elements
+            for (std::size_t row = begin + 1; row < end; ++row) {
+                const T *previous = line + (row - 1) * inner;
+                T *current = line + row * inner;
+                for (std::size_t index = 0; index < inner; ++index) {
+                    current[index] = op(previous[index], current[index]);
+                }
+            }
+        }
+
+        // Inclusive scan of columns [first, last) over all rows of one line (an axis other than the contiguous one)
+        template<typename T, typename BinaryOp>
+        void scan_columns(T *line, std::size_t length, std::size_t inner, std::size_t first, std::size_t last,
+                          BinaryOp op) {
+            for (std::size_t row = 1; row < length; ++row) {
+                const T *previous = line + (row - 1) * inner;
+                T *current = line + row * inner;
+                for (std::size_t index = first; index < last; ++index) {
+                    current[index] = op(previous[index], current[index]);
+                }
+            }
+        }
+
+        // Exclusive scan of columns [first, last) over all rows of one line, carrying the running row in a buffer
+        template<typename T, typename BinaryOp>
+        void exclusive_scan_columns(T *line, std::size_t length, std::size_t inner, std::size_t first,
+                                    std::size_t last, const T &identity, BinaryOp op) {
+            std::vector<T> running(last - first, identity);
+            for (std::size_t row = 0; row < length; ++row) {
+                T *current = line + row * inner + first;
+                for (std::size_t index = 0; index < last - first; ++index) {
+                    T value = current[index];
+                    current[index] = running[index];
+                    running[index] = op(running[index], value);
+                }
+            }
+        }
+
+        // Inclusive scan of one whole line, or exclusive scan when identity is not null
+        template<typename T, typename BinaryOp>
+        void scan_line(T *line, std::size_t length, std::size_t inner, const T *identity, BinaryOp op) {
+            if (identity == nullptr) {
+                scan_block(line, 0, length, inner, op);
+            } else if (inner == 1) {
+                // Keep the in-register row scan and shift the row while it is still in cache
+                scan_row(line, length, op);
+                std::copy_backward(line, line + length - 1, line + length);
+                line[0] = *identity;
+            } else {
+                exclusive_scan_columns(line, length, inner, 0, inner, *identity, op);
+            }
+        }
+
+        // Combines carry (one row of inner elements) into rows [begin, end) of one line
+        template<typename T, typename BinaryOp>
+        void apply_carry(T *line, std::size_t begin, std::size_t end, std::size_t inner, const T *carry, BinaryOp op) {
+            for (std::size_t row = begin; row < end; ++row) {
+                T *current = line + row * inner;
+                for (std::size_t index = 0; index < inner; ++index) {
+                    current[index] = op(carry[index], current[index]);
+                }
+            }
+        }
+
+        // Turns the locally scanned rows [begin, end) of one line into their exclusive results: every row takes
+        // the previous row combined with carry, and the first row takes carry itself (identity when carry is null)
+        template<typename T, typename BinaryOp>
+        void apply_carry_exclusive(T *line, std::size_t begin, std::size_t end, std::size_t inner, const T *carry,
+                                   const T &identity, BinaryOp op) {
+            for (std::size_t row = end - 1; row > begin; --row) {
+                const T *previous = line + (row - 1) * inner;
+                T *current = line + row * inner;
+                for (std::size_t index = 0; index < inner; ++index) {
+                    current[index] = carry == nullptr ? previous[index] : op(carry[index], previous[index]);
+                }
+            }
+            T *first = line + begin * inner;
+            for (std::size_t index = 0; index < inner; ++index) {
+                first[index] = carry == nullptr ? identity : carry[index];
+            }
+        }
+
+        // Runs function(begin, end) over count items split evenly across threads, one chunk on the calling thread
+        template<typename Function>
+        void parallel_for(std::size_t count, unsigned threads, Function function) {
+            std::vector<std::thread> workers;
+            for (unsigned thread = 1; thread < threads; ++thread) {
+                workers.emplace_back(function, count * thread / threads, count * (thread + 1) / threads);
+            }
+            function(0, count / threads);
+            for (std::size_t thread = 0; thread < workers.size(); ++thread) {
+                workers[thread].join();
+            }
+        }
+
+        /*
+         * Inclusive scan of data along the axis described by shape, or exclusive scan starting from *identity
+         * when identity is not null. The exclusive shift happens inside each thread's share of the work.
+         *
+         * With enough independent lines each thread scans whole lines. Along an outer axis with enough
+         * columns, the columns are independent too and each thread scans a range of them in one pass.
+         * Otherwise the axis is split into one block per thread and scanned in two passes: every thread
+         * scans its block locally, the carries between blocks are combined serially, and every thread
+         * then folds its carry into its block.
+         * op must be associative; floating-point results may differ from a serial scan in the last bits.
+         */
+        template<typename T, typename BinaryOp>
+        void scan_axis(T *data, const Scan_Shape &shape, BinaryOp op, unsigned threads, const T *identity = nullptr) {
+            const std::size_t line_size = shape.length * shape.inner;
+
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            if (shape.outer * line_size < MS_ARRAY_SCAN_PARALLEL_THRESHOLD) {
+                threads = 1;
+            }
+
+            // Fewest columns per thread worth splitting an outer axis by column (keeps threads off each other's cache lines)
+            const std::size_t min_columns = 16;
+
+            // Independent lines are scanned in parallel
+            if (shape.outer >= threads) {
+                parallel_for(shape.outer, threads, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t line = begin; line < end; ++line) {
+                        scan_line(data + line * line_size, shape.length, shape.inner, identity, op);
+                    }
+                });
+                return;
+            }
+
+            // Independent columns of an outer axis are scanned in parallel
+            if (shape.inner >= min_columns * threads) {
+                parallel_for(shape.inner, threads, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t line = 0; line < shape.outer; ++line) {
+                        if (identity == nullptr) {
+                            scan_columns(data + line * line_size, shape.length, shape.inner, begin, end, op);
+                        } else {
+                            exclusive_scan_columns(data + line * line_size, shape.length, shape.inner, begin, end,
+                                                   *identity, op);
+                        }
+                    }
+                });
+                return;
+            }
+
+            // Axis too short to split, scan the few lines as they are
+            if (shape.length < 2 * threads) {
+                parallel_for(shape.outer, static_cast<unsigned>(shape.outer), [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t line = begin; line < end; ++line) {
+                        scan_line(data + line * line_size, shape.length, shape.inner, identity, op);
+                    }
+                });
+                return;
+            }
+
+            // Pass 1: local scan of every block of the axis
+            parallel_for(threads, threads, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t block = begin; block < end; ++block) {
+                    for (std::size_t line = 0; line < shape.outer; ++line) {
+                        scan_block(data + line * line_size, shape.length * block / threads,
+                                   shape.length * (block + 1) / threads, shape.inner, op);
+                    }
+                }
+            });
+
+            // Carry into block b is the total of blocks [0, b), built from the last row of every block
+            std::vector<T> carries(threads * shape.outer * shape.inner);
+            for (std::size_t block = 1; block < threads; ++block) {
+                std::size_t last_row = shape.length * block / threads - 1;
+                for (std::size_t line = 0; line < shape.outer; ++line) {
+                    const T *last = data + line * line_size + last_row * shape.inner;
+                    T *carry = &carries[(block * shape.outer + line) * shape.inner];
+                    const T *previous = &carries[((block - 1) * shape.outer + line) * shape.inner];
+                    for (std::size_t index = 0; index < shape.inner; ++index) {
+                        carry[index] = block == 1 ? last[index] : op(previous[index], last[index]);
+                    }
+                }
+            }
+
+            // Pass 2 (exclusive): shift every block by one row while folding in its carry
+            if (identity != nullptr) {
+                parallel_for(threads, threads, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t block = begin; block < end; ++block) {
+                        for (std::size_t line = 0; line < shape.outer; ++line) {
+                            apply_carry_exclusive(data + line * line_size, shape.length * block / threads,
+                                                  shape.length * (block + 1) / threads, shape.inner,
+                                                  block == 0 ? nullptr : &carries[(block * shape.outer + line) * shape.inner],
+                                                  *identity, op);
+                        }
+                    }
+                });
+                return;
+            }
+
+            // Pass 2: fold the carries into every block but the first
+            parallel_for(threads - 1, threads - 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t block = begin + 1; block < end + 1; ++block) {
+                    for (std::size_t line = 0; line < shape.outer; ++line) {
+                        apply_carry(data + line * line_size, shape.length * block / threads,
+                                    shape.length * (block + 1) / threads, shape.inner,
+                                    &carries[(block * shape.outer + line) * shape.inner], op);
+                    }
+                }
+            });
+        }
+    }
+
+    // Replaces every element with op applied to it and all preceding elements along axis (inclusive scan).
+    // threads == 0 uses every hardware thread. Throws Out_Of_Range_Exception if axis is not below the rank.
+    template<typename T, std::size_t... Dims, typename BinaryOp>
+    void inclusive_scan(Array<T, Dims...> &array, std::size_t axis, BinaryOp op, unsigned threads = 0) {
+        detail::scan_axis(array.data(), detail::scan_shape<Dims...>(axis), op, threads);
+    }
+
+    // Replaces every element with op applied to all preceding elements along axis, the first row
+    // receiving identity (exclusive scan). Throws Out_Of_Range_Exception if axis is not below the rank.
+    template<typename T, std::size_t... Dims, typename BinaryOp>
+    void exclusive_scan(Array<T, Dims...> &array, std::size_t axis, BinaryOp op, const T &identity, unsigned threads = 0) {
+        detail::scan_axis(array.data(), detail::scan_shape<Dims...>(axis), op, threads, &identity);
+    }
+
+    // Cumulative sum along axis
+    template<typename T, std::size_t... Dims>
+    void cumsum(Array<T, Dims...> &array, std::size_t axis, unsigned threads = 0) {
+        inclusive_scan(array, axis, std::plus<T>(), threads);
+    }
+
+    // Cumulative product along axis
+    template<typename T, std::size_t... Dims>
+    void cumprod(Array<T, Dims...> &array, std::size_t axis, unsigned threads = 0) {
+        inclusive_scan(array, axis, std::multiplies<T>(), threads);
+    }
+
+    // Turns array into its summed-area table: every element becomes the sum of all elements whose
+    // indices are less than or equal to its own along every axis.
+    template<typename T, std::size_t... Dims>
+    void summed_area_table(Array<T, Dims...> &array, unsigned threads = 0) {
+        for (std::size_t axis = 0; axis < sizeof...(Dims); ++axis) {
+            cumsum(array, axis, threads);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef MS_ARRAY_SNAPSHOT
+#define MS_ARRAY_SNAPSHOT
+
+#include "arbitrary_dim_array.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ms {
+
+    /*
+     * Custom Exception Class -> invoked when every reader slot of a SnapshotArray is already taken
+     */
+    class Reader_Limit_Exception : public std::exception {
+    public:
+        const char *what() const throw() {
+            return "\nReader_Limit_Exception\n";
+        }
+    };
+
+    /*
+     * Container publishing immutable versions of an Array<T, Dim, Dims...> to concurrent readers.
+     *
+     * A single writer thread prepares the next version in a staging buffer and publishes it with
+     * an atomic pointer swap. Readers pin the current version through a Reader handle; pinning is
+     * wait-free (one load, one store, one load, one store) and the pinned Array is never modified
+     * while the View is alive. Retired versions are reclaimed with epoch-based reclamation: a reader
+     * first announces the global epoch E, which protects every version retired in epoch E or later,
+     * and then replaces the announcement with the version it loaded, which protects that version only.
+     * A preempted reader therefore holds back a single version instead of every newer one.
+     *
+     * Recycled versions become the next staging buffer, so steady state is double-buffered. Every
+     * version stamps each outer-dimension slab with the version that last wrote it; when a buffer
+     * is recycled only the slabs whose stamp differs from the current version are copied across
+     * (copy-on-write of outer slabs). Use write(index) to touch a single slab, and write() when the
+     * whole array may change.
+     *
+     * All writer functions (write, publish, latest) must be called from one thread. Every Reader
+     * must be destroyed before the SnapshotArray it was created from.
+     */
+    template<typename T, std::size_t Dim, std::size_t... Dims>
+    class SnapshotArray {
+    public:
+        typedef Array<T, Dim, Dims...> ArrayType;
+        typedef typename std::remove_reference<decltype(std::declval<ArrayType &>()[0])>::type SlabType;
+
+    private:
+        // One published version together with its per-slab write stamps
+        struct Version {
+            ArrayType _data;                  // Array contents of this version
+            std::uint64_t _number;            // Monotonic version number (1 for the initial array)
+            std::uint64_t _slab_stamp[Dim];   // Version number that last wrote each outer slab
+        };
+
+        // Reader announcement slot, padded to a cache line to avoid false sharing between readers.
+        // _pin holds 0 when idle, (epoch << 1) | 1 while loading, or the pinned Version pointer.
+        struct alignas(64) Slot {
+            std::atomic<std::uintptr_t> _pin{0};   // Announcement of the pinned View
+            std::atomic<bool> _in_use{false};      // Whether a Reader owns this slot
+        };
+
+    public:
+        /*
+         * Read-only, consistent view of one published version. Keeps the version pinned until destroyed.
+         */
+        class View {
+        public:
+            // Move constructor, the moved-from view no longer pins anything
+            View(View &&view) : _slot{view._slot}, _version{view._version} {
+                view._slot = nullptr;
+                view._version = nullptr;
+            }
+
+            View(const View &) = delete;
+            View &operator=(const View &) = delete;
+
+            // Releases the pinned version
+            ~View() {
+                if (_slot != nullptr) {
+                    _slot->_pin.store(0, std::memory_order_release);
+                }
+            }
+
+            // Overloaded operator [] to access elements of the pinned version
+            const SlabType &operator[](std::size_t index) const {
+                return _version->_data[index];
+            }
+
+            // Returns the pinned Array
+            const ArrayType &operator*() const {
+                return _version->_data;
+            }
+
+            const ArrayType *operator->() const {
+                return &_version->_data;
+            }
+
+            // Returns the number of the pinned version
+            std::uint64_t version() const {
+                return _version->_number;
+            }
+
+        private:
+            friend class SnapshotArray;
+
+            // Value constructor used by Reader::read()
+            View(Slot *slot, const Version *version) : _slot{slot}, _version{version} {}
+
+            Slot *_slot;                // Announcement slot cleared on destruction
+            const Version *_version;    // Pinned version
+        };
+
+        /*
+         * Per-thread reader handle. Owns one announcement slot; at most one View per Reader may be alive at a time,
+         * and every View must be destroyed before the Reader that created it.
+         */
+        class Reader {
+        public:
+            // Claims a free slot of the snapshot array. Throws Reader_Limit_Exception when none is left.
+            explicit Reader(SnapshotArray &snapshot) : _snapshot{&snapshot}, _slot{snapshot.acquire_slot()} {}
+
+            Reader(const Reader &) = delete;
+            Reader &operator=(const Reader &) = delete;
+
+            // Returns the slot to the snapshot array. The slot's pin is not cleared, so no View may outlive its Reader.
+            ~Reader() {
+                _slot->_in_use.store(false, std::memory_order_release);
+            }
+
+            // Pins and returns the latest published version (wait-free)
+            View read() {
+                // A second live View would share this slot and lose its pin when the first one is destroyed
+                assert(_slot->_pin.load(std::memory_order_relaxed) == 0);
+
+                std::uintptr_t epoch = _snapshot->_epoch.load(std::memory_order_seq_cst);
+                _slot->_pin.store((epoch << 1) | 1, std::memory_order_seq_cst);
+                const Version *version = _snapshot->_current.load(std::memory_order_seq_cst);
+                _slot->_pin.store(reinterpret_cast<std::uintptr_t>(version), std::memory_order_seq_cst);
+                return View(_slot, version);
+            }
+
+        private:
+            SnapshotArray *_snapshot;   // Snapshot array the slot belongs to
+            Slot *_slot;                // Announcement slot owned by this reader
+        };
+
+        // Default constructor, publishes a default constructed array as version 1
+        explicit SnapshotArray(std::size_t max_readers = 64)
+                : _slots{new Slot[max_readers]}, _slot_count{max_readers}, _epoch{1}, _current{new Version},
+                  _staging{nullptr}, _staging_all_dirty{false} {
+            stamp_initial_version();
+        }
+
+        // Value constructor, publishes a copy of array as version 1
+        explicit SnapshotArray(const ArrayType &array, std::size_t max_readers = 64)
+                : _slots{new Slot[max_readers]}, _slot_count{max_readers}, _epoch{1}, _current{new Version},
+                  _staging{nullptr}, _staging_all_dirty{false} {
+            _current.load(std::memory_order_relaxed)->_data = array;
+            stamp_initial_version();
+        }
+
+        SnapshotArray(const SnapshotArray &) = delete;
+        SnapshotArray &operator=(const SnapshotArray &) = delete;
+
+        // Frees every version still owned by the container
+        ~SnapshotArray() {
+            delete _current.load(std::memory_order_acquire);
+            delete _staging;
+            for (std::size_t index = 0; index < _retired.size(); ++index) {
+                delete _retired[index].first;
+            }
+            for (std::size_t index = 0; index < _free.size(); ++index) {
+                delete _free[index];
+            }
+        }
+
+        // Returns the whole staging array for modification. Every slab is copied into the next recycled buffer.
+        ArrayType &write() {
+            prepare_staging();
+            _staging_all_dirty = true;
+            return _staging->_data;
+        }
+
+        // Returns one outer slab of the staging array for modification. Only this slab is marked as changed.
+        SlabType &write(std::size_t index) {
+
+            // Throw exception if index is greater than the size of the array
+            if (index >= Dim) {
+                throw Out_Of_Range_Exception();
+            }
+
+            prepare_staging();
+            _staging->_slab_stamp[index] = _staging->_number;
+            return _staging->_data[index];
+        }
+
+        // Publishes the staging array as the latest version and reclaims versions no reader can still see.
+        // Publishing without a preceding write() is a no-op.
+        void publish() {
+            if (_staging == nullptr) {
+                return;
+            }
+            if (_staging_all_dirty) {
+                for (std::size_t index = 0; index < Dim; ++index) {
+                    _staging->_slab_stamp[index] = _staging->_number;
+                }
+            }
+
+            Version *old = _current.exchange(_staging, std::memory_order_seq_cst);
+            std::uintptr_t epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+            _retired.push_back(std::make_pair(old, epoch));
+            _staging = nullptr;
+            _staging_all_dirty = false;
+
+            reclaim();
+        }
+
+        // Returns the latest published array (writer thread only)
+        const ArrayType &latest() const {
+            return _current.load(std::memory_order_relaxed)->_data;
+        }
+
+        // Returns the number of the latest published version (writer thread only)
+        std::uint64_t version() const {
+            return _current.load(std::memory_order_relaxed)->_number;
+        }
+
+    private:
+        // Marks the version created by a constructor as version 1
+        void stamp_initial_version() {
+            Version *version = _current.load(std::memory_order_relaxed);
+            version->_number = 1;
+            for (std::size_t index = 0; index < Dim; ++index) {
+                version->_slab_stamp[index] = 1;
+            }
+        }
+
+        // Claims an idle reader slot
+        Slot *acquire_slot() {
+            for (std::size_t index = 0; index < _slot_count; ++index) {
+                bool expected = false;
+                if (_slots[index]._in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return &_slots[index];
+                }
+            }
+            throw Reader_Limit_Exception();
+        }
+
+        // Makes _staging a writable copy of the latest version, recycling a reclaimed buffer when possible
+        void prepare_staging() {
+            if (_staging != nullptr) {
+                return;
+            }
+
+            const Version *current = _current.load(std::memory_order_relaxed);
+            if (_free.empty()) {
+                _staging = new Version(*current);
+            } else {
+                _staging = _free.back();
+                _free.pop_back();
+
+                // Copy only the outer slabs written since this buffer was last published
+                for (std::size_t index = 0; index < Dim; ++index) {
+                    if (_staging->_slab_stamp[index] != current->_slab_stamp[index]) {
+                        _staging->_data[index] = current->_data[index];
+                        _staging->_slab_stamp[index] = current->_slab_stamp[index];
+                    }
+                }
+            }
+            _staging->_number = current->_number + 1;
+        }
+
+        // Moves every retired version no reader can still hold to the free list
+        void reclaim() {
+            std::uintptr_t oldest = _epoch.load(std::memory_order_seq_cst);
+            _pinned.clear();
+            for (std::size_t index = 0; index < _slot_count; ++index) {
+                std::uintptr_t pin = _slots[index]._pin.load(std::memory_order_seq_cst);
+                if (pin & 1) {
+                    if ((pin >> 1) < oldest) {
+                        oldest = pin >> 1;
+                    }
+                } else if (pin != 0) {
+                    _pinned.push_back(reinterpret_cast<const Version *>(pin));
+                }
+            }
+
+            std::size_t kept = 0;
+            for (std::size_t index = 0; index < _retired.size(); ++index) {
+                if (_retired[index].second < oldest && !is_pinned(_retired[index].first)) {
+                    _free.push_back(_retired[index].first);
+                } else {
+                    _retired[kept++] = _retired[index];
+                }
+            }
+            _retired.resize(kept);
+        }
+
+        // Checks whether a reader announced version as its pinned version
+        bool is_pinned(const Version *version) const {
+            for (std::size_t index = 0; index < _pinned.size(); ++index) {
+                if (_pinned[index] == version) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*
+         * Class member variables
+         */
+        std::unique_ptr<Slot[]> _slots;                              // Reader announcement slots
+        std::size_t _slot_count;                                     // Number of reader slots
+        std::atomic<std::uintptr_t> _epoch;                          // Global reclamation epoch
+        std::atomic<Version *> _current;                             // Latest published version
+        Version *_staging;                                           // Version being prepared by the writer
+        bool _staging_all_dirty;                                     // Whether write() exposed the whole staging array
+        std::vector<std::pair<Version *, std::uintptr_t>> _retired;  // Replaced versions with their retire epoch
+        std::vector<Version *> _free;                                // Reclaimed versions ready for reuse
+        std::vector<const Version *> _pinned;                        // Versions announced by readers during reclaim()
+    };
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef MS_BENCHMARK_HELPERS
+#define MS_BENCHMARK_HELPERS
+
+#include <chrono>
+
+namespace ms {
+
+    namespace benchmark {
+
+        const int Repetitions = 3;
+
+        // Returns the best time in milliseconds of Repetitions runs of run(), calling setup() untimed before each run
+        template<typename Setup, typename Function>
+        double best_of(Setup setup, Function run) {
+            double best = 0;
+            for (int repetition = 0; repetition < Repetitions; ++repetition) {
+                setup();
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                run();
+                double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (repetition == 0 || elapsed < best) {
+                    best = elapsed;
+                }
+            }
+            return best;
+        }
+
+        // Returns the best time in milliseconds of Repetitions runs of run()
+        template<typename Function>
+        double best_of(Function run) {
+            return best_of([]() {}, run);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "arbitrary_dim_array.hpp"
+#include "benchmark_helpers.hpp"
+#include <cstring>
+#include <new>
+#include <utility>
+
+// Benchmark of Array construction followed by initialization of every element
+namespace {
+
+    using ms::benchmark::best_of;
+
+    /*
+     * Layout and constructor of Array before it became trivially constructible: every nested array
+     * stored its own _array_size, which the constructor set, touching every row once.
+     */
+    template<typename T, std::size_t... Dims>
+    struct Legacy_Array;
+
+    template<typename T, std::size_t Dim, std::size_t... Dims>
+    struct Legacy_Array<T, Dim, Dims...> {
+        Legacy_Array() : _array_size{Dim} {}
+
+        Legacy_Array<T, Dims...> _array[Dim];
+        std::size_t _array_size;
+    };
+
+    template<typename T, std::size_t Dim>
+    struct Legacy_Array<T, Dim> {
+        Legacy_Array() : _array_size{Dim} {}
+
+        T _array[Dim];
+        std::size_t _array_size;
+    };
+
+    // Allocates bytes of storage and touches every page, so timed runs do not pay first-touch page faults
+    void *prefaulted(std::size_t bytes) {
+        void *storage = ::operator new(bytes);
+        std::memset(storage, 0xff, bytes);
+        return storage;
+    }
+
+    // Prints one result line with the achieved bandwidth
+    void report(const char *size, const char *method, double milliseconds, std::size_t bytes) {
+        std::cout << size << "\t" << method << "\t" << milliseconds << " ms\t"
+                  << bytes / milliseconds / 1.0e6 << " GB/s" << std::endl;
+    }
+
+    // Compares construction plus iterator loop with fill() and zero(), all in pre-faulted storage
+    template<typename T, std::size_t... Dims>
+    void compare(const char *size) {
+        typedef ms::Array<T, Dims...> ArrayType;
+        typedef Legacy_Array<T, Dims...> LegacyType;
+        const std::size_t bytes = sizeof(ArrayType);
+        void *storage = prefaulted(sizeof(ArrayType));
+        void *legacy_storage = prefaulted(sizeof(LegacyType));
+        volatile T sink = 0;
+        volatile std::size_t legacy_sink = 0;
+
+        // Old constructor (row metadata) followed by an iterator loop over the elements
+        report(size, "legacy constructor + iterator", best_of([&]() {
+            LegacyType *legacy = new(legacy_storage) LegacyType;
+            legacy_sink = legacy->_array[0]._array_size;
+            ArrayType *array = new(storage) ArrayType;
+            for (typename ArrayType::FirstDimensionIterator it = array->fmbegin(); it != array->fmend(); ++it) {
+                *it = T(1);
+            }
+            sink = array->data()[ArrayType::_total_size - 1];
+        }), bytes);
+
+        report(size, "constructor + iterator", best_of([&]() {
+            ArrayType *array = new(storage) ArrayType;
+            for (typename ArrayType::FirstDimensionIterator it = array->fmbegin(); it != array->fmend(); ++it) {
+                *it = T(1);
+            }
+            sink = array->data()[ArrayType::_total_size - 1];
+        }), bytes);
+
+        report(size, "uninitialized + fill", best_of([&]() {
+            ArrayType *array = new(storage) ArrayType(ms::uninitialized);
+            array->fill(T(1));
+            sink = array->data()[ArrayType::_total_size - 1];
+        }), bytes);
+
+        report(size, "uninitialized + zero", best_of([&]() {
+            ArrayType *array = new(storage) ArrayType(ms::uninitialized);
+            array->zero();
+            sink = array->data()[ArrayType::_total_size - 1];
+        }), bytes);
+
+        ::operator delete(storage);
+        ::operator delete(legacy_storage);
+        (void) sink;
+        (void) legacy_sink;
+    }
+}
+
+// Program to compare Array initialization methods below and above MS_ARRAY_STREAMING_THRESHOLD
+int main() {
+    std::cout << "size\tmethod\ttime\tbandwidth" << std::endl;
+    compare<float, 512, 512>("1 MiB");
+    compare<float, 8192, 8192>("256 MiB");
+}
@@ -1,12 +1,18 @@
 #include "arbitrary_dim_array.hpp"
+#include "array_scan.hpp"
+#include "array_snapshot.hpp"
+#include <atomic>
 #include <cassert>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 // Program to test Arbitrary Dimension Array implementation
 int main() {
 
     // Define a [2 X 3 X 4] array of integers
-    nm::Array<int, 2, 3, 4> arr1, arr2;
-    nm::Array<short, 2, 3, 4> arr3;
+    ms::Array<int, 2, 3, 4> arr1, arr2;
+    ms::Array<short, 2, 3, 4> arr3;
 
     // Initialize the arrays
     int value = 0;
@@ -32,7 +38,7 @@ int main() {
     try {
         arr1[0][3][0] = 1;
         assert(false);
-    } catch (nm::Out_Of_Range_Exception &ex) {
+    } catch (ms::Out_Of_Range_Exception &ex) {
         std::cout << ex.what() << std::endl;
     }
 
@@ -47,18 +53,214 @@ int main() {
 
     // Iterator through array in Row Major Order
     std::cout << "Array elements in Row Major Order using First Dimension Iterator:- " << std::endl;
-    for (nm::Array<int, 2, 3, 4>::FirstDimensionIterator it = arr1.fmbegin(); it != arr1.fmend(); ++it) {
+    for (ms::Array<int, 2, 3, 4>::FirstDimensionIterator it = arr1.fmbegin(); it != arr1.fmend(); ++it) {
         std::cout << *it << " ";
     }
     std::cout << "\n" << std::endl;
 
     // Iterator through array in Column Major Order
     std::cout << "Array elements in Column Major Order using Last Dimension Iterator:- " << std::endl;
-    for (nm::Array<int, 2, 3, 4>::LastDimensionIterator it = arr1.lmbegin(); it != arr1.lmend(); ++it) {
+    for (ms::Array<int, 2, 3, 4>::LastDimensionIterator it = arr1.lmbegin(); it != arr1.lmend(); ++it) {
         std::cout << *it << " ";
     }
     std::cout << std::endl;
 
     // Test the type of Array object
-    assert(typeid(nm::Array<double, 1>::ValueType) == typeid(double));
+    assert(typeid(ms::Array<double, 1>::ValueType) == typeid(double));
+
+    // Construction is trivial for trivial element types, elements are stored contiguously
+    static_assert(std::is_trivially_default_constructible<ms::Array<int, 2, 3, 4>>::value, "Array<int> must be trivial");
+    static_assert(sizeof(ms::Array<int, 2, 3, 4>) == 24 * sizeof(int), "Array must not store metadata");
+    assert(arr1.data() == &arr1[0][0][0] && arr1.data() + 23 == &arr1[1][2][3]);
+
+    // Bulk fill and zero
+    ms::Array<int, 2, 3, 4> arr4(ms::uninitialized);
+    arr4.fill(7);
+    for (ms::Array<int, 2, 3, 4>::FirstDimensionIterator it = arr4.fmbegin(); it != arr4.fmend(); ++it) {
+        assert(*it == 7);
+    }
+    arr4.zero();
+    assert(arr4[0][0][0] == 0 && arr4[1][2][3] == 0);
+
+    // Value-initialization zeroes, the uninitialized tag does not have to
+    ms::Array<double, 3, 5> *arr5 = new ms::Array<double, 3, 5>();
+    assert((*arr5)[2][4] == 0.0);
+    delete arr5;
+
+    // Arrays above MS_ARRAY_STREAMING_THRESHOLD are filled with non-temporal stores
+    ms::Array<short, 4099, 4097> *large = new ms::Array<short, 4099, 4097>(ms::uninitialized);
+    large->fill(-3);
+    assert((*large)[0][0] == -3 && (*large)[2048][1] == -3 && (*large)[4098][4096] == -3);
+    large->zero();
+    assert((*large)[0][0] == 0 && (*large)[4098][4096] == 0);
+    delete large;
+
+    // Inclusive and exclusive scans along every axis match hand-written loops
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        ms::Array<int, 2, 3, 4> inclusive = arr2, exclusive = arr2;
+        ms::cumsum(inclusive, axis);
+        ms::exclusive_scan(exclusive, axis, std::plus<int>(), 0);
+        for (std::size_t i = 0; i < 2; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                for (std::size_t k = 0; k < 4; ++k) {
+                    std::size_t index[] = {i, j, k};
+                    int sum = 0;
+                    for (std::size_t step = 0; step <= index[axis]; ++step) {
+                        std::size_t at[] = {i, j, k};
+                        at[axis] = step;
+                        sum += arr2[at[0]][at[1]][at[2]];
+                    }
+                    assert(inclusive[i][j][k] == sum);
+                    assert(exclusive[i][j][k] == sum - arr2[i][j][k]);
+                }
+            }
+        }
+    }
+
+    // Cumulative product
+    ms::Array<long, 5> factorial;
+    for (std::size_t i = 0; i < 5; ++i) {
+        factorial[i] = static_cast<long>(i + 1);
+    }
+    ms::cumprod(factorial, 0);
+    assert(factorial[4] == 120);
+
+    // Summed-area table: the last element holds the total
+    ms::Array<int, 2, 3, 4> table;
+    for (std::size_t index = 0; index < 24; ++index) {
+        table.data()[index] = static_cast<int>(index);
+    }
+    ms::summed_area_table(table);
+    assert(table[1][2][3] == 23 * 24 / 2 && table[0][1][1] == 0 + 1 + 4 + 5);
+
+    // Out of range axis, throws exception
+    try {
+        ms::cumsum(table, 3);
+        assert(false);
+    } catch (ms::Out_Of_Range_Exception &ex) {
+    }
+
+    // Multi-threaded blocked scans agree with the serial scan on both the contiguous and the outer axes
+    ms::Array<int, 3, 70001> *serial = new ms::Array<int, 3, 70001>;
+    ms::Array<int, 3, 70001> *parallel = new ms::Array<int, 3, 70001>;
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 70001; ++j) {
+            (*serial)[i][j] = (*parallel)[i][j] = static_cast<int>((i * 7 + j * 13) % 17) - 8;
+        }
+    }
+    for (std::size_t axis = 0; axis < 2; ++axis) {
+        ms::cumsum(*serial, axis, 1);
+        ms::cumsum(*parallel, axis, 4);
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 70001; ++j) {
+                assert((*serial)[i][j] == (*parallel)[i][j]);
+            }
+        }
+    }
+    for (std::size_t axis = 0; axis < 2; ++axis) {
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 70001; ++j) {
+                (*serial)[i][j] = (*parallel)[i][j] = static_cast<int>((i * 7 + j * 13) % 17) - 8;
+            }
+        }
+        ms::exclusive_scan(*serial, axis, std::plus<int>(), 0, 1);
+        ms::exclusive_scan(*parallel, axis, std::plus<int>(), 0, 4);
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 70001; ++j) {
+                assert((*serial)[i][j] == (*parallel)[i][j]);
+            }
+        }
+    }
+    ms::Array<int, 70001, 3> *transposed = new ms::Array<int, 70001, 3>;
+    transposed->fill(1);
+    ms::exclusive_scan(*transposed, 0, std::plus<int>(), 0, 4);
+    assert((*transposed)[0][2] == 0 && (*transposed)[70000][1] == 70000);
+    delete serial;
+    delete parallel;
+    delete transposed;
+
+    // In-register float scan
+    ms::Array<float, 4, 9> ramp;
+    ramp.fill(0.5f);
+    ms::cumsum(ramp, 1);
+    assert(ramp[3][0] == 0.5f && ramp[3][7] == 4.0f && ramp[3][8] == 4.5f);
+
+    // Snapshot publishing: a pinned view keeps its version while the writer publishes new ones
+    ms::SnapshotArray<int, 2, 3, 4> snapshot(arr2);
+    ms::SnapshotArray<int, 2, 3, 4>::Reader reader(snapshot);
+    {
+        ms::SnapshotArray<int, 2, 3, 4>::View view = reader.read();
+        assert(view.version() == 1);
+
+        snapshot.write(1)[2][3] = -1;  // Copy-on-write of the outer slab 1 only
+        snapshot.publish();
+        assert(view[1][2][3] == arr2[1][2][3]);
+        assert(snapshot.version() == 2);
+    }
+    assert(reader.read()[1][2][3] == -1);
+
+    // Recycled buffers pick up slabs written by versions they missed
+    for (int tick = 0; tick < 4; ++tick) {
+        snapshot.write(tick % 2)[0][0] = tick;
+        snapshot.publish();
+    }
+    {
+        ms::SnapshotArray<int, 2, 3, 4>::View view = reader.read();
+        assert(view[0][0][0] == 2 && view[1][0][0] == 3 && view[1][2][3] == -1);
+    }
+
+    // Out of range slab, throws exception
+    try {
+        snapshot.write(2);
+        assert(false);
+    } catch (ms::Out_Of_Range_Exception &ex) {
+    }
+
+    // Reader limit, throws exception
+    try {
+        ms::SnapshotArray<int, 2, 3, 4> limited(1);
+        ms::SnapshotArray<int, 2, 3, 4>::Reader first(limited);
+        ms::SnapshotArray<int, 2, 3, 4>::Reader second(limited);
+        assert(false);
+    } catch (ms::Reader_Limit_Exception &ex) {
+    }
+
+    // Concurrent readers always observe a consistent version (every element equals the version tick)
+    ms::SnapshotArray<int, 64, 64> live;
+    for (std::size_t i = 0; i < 64; ++i) {
+        for (std::size_t j = 0; j < 64; ++j) {
+            live.write()[i][j] = 0;
+        }
+    }
+    live.publish();
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int thread = 0; thread < 4; ++thread) {
+        readers.emplace_back([&live, &done]() {
+            ms::SnapshotArray<int, 64, 64>::Reader live_reader(live);
+            while (!done.load()) {
+                ms::SnapshotArray<int, 64, 64>::View view = live_reader.read();
+                int tick = view[0][0];
+                for (std::size_t i = 0; i < 64; ++i) {
+                    for (std::size_t j = 0; j < 64; ++j) {
+                        assert(view[i][j] == tick);
+                    }
+                }
+            }
+        });
+    }
+    for (int tick = 1; tick <= 2000; ++tick) {
+        ms::Array<int, 64, 64> &next = live.write();
+        for (std::size_t i = 0; i < 64; ++i) {
+            for (std::size_t j = 0; j < 64; ++j) {
+                next[i][j] = tick;
+            }
+        }
+        live.publish();
+    }
+    done.store(true);
+    for (std::size_t thread = 0; thread < readers.size(); ++thread) {
+        readers[thread].join();
+    }
 }
@@ -0,0 +1,73 @@
+#include "arbitrary_dim_array.hpp"
+#include "array_scan.hpp"
+#include "benchmark_helpers.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+// Benchmark of cumsum along every axis across thread counts
+namespace {
+
+    using ms::benchmark::best_of;
+
+    // Prints one result line with the achieved throughput
+    void report(const char *shape, const char *method, std::size_t axis, unsigned threads, double milliseconds,
+                std::size_t elements) {
+        std::cout << shape << "\t" << method << "\t" << axis << "\t" << threads << "\t" << milliseconds << " ms\t"
+                  << elements / milliseconds / 1.0e3 << " Melem/s" << std::endl;
+    }
+
+    // Times cumsum along every axis of ArrayType for 1, 2, 4, ... max_threads threads
+    template<typename ArrayType, std::size_t Rank>
+    void compare(const char *shape, unsigned max_threads) {
+        ArrayType *array = new ArrayType(ms::uninitialized);
+        for (std::size_t axis = 0; axis < Rank; ++axis) {
+            for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+                report(shape, "cumsum", axis, threads, best_of([&]() {
+                    array->fill(1.0f);
+                }, [&]() {
+                    ms::cumsum(*array, axis, threads);
+                }), ArrayType::_total_size);
+            }
+        }
+        delete array;
+    }
+
+    // Hand-written serial loops over operator[], the pattern cumsum replaces
+    void compare_loops() {
+        typedef ms::Array<float, 4096, 4096> Grid;
+        Grid *grid = new Grid(ms::uninitialized);
+
+        report("4096x4096", "loops", 0, 1, best_of([&]() {
+            grid->fill(1.0f);
+        }, [&]() {
+            for (std::size_t i = 1; i < 4096; ++i) {
+                for (std::size_t j = 0; j < 4096; ++j) {
+                    (*grid)[i][j] += (*grid)[i - 1][j];
+                }
+            }
+        }), Grid::_total_size);
+
+        report("4096x4096", "loops", 1, 1, best_of([&]() {
+            grid->fill(1.0f);
+        }, [&]() {
+            for (std::size_t i = 0; i < 4096; ++i) {
+                for (std::size_t j = 1; j < 4096; ++j) {
+                    (*grid)[i][j] += (*grid)[i][j - 1];
+                }
+            }
+        }), Grid::_total_size);
+        delete grid;
+    }
+}
+
+// Program to measure scan scaling across core counts and axis choices
+int main(int argc, char **argv) {
+    unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10))
+                                    : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "shape\tmethod\taxis\tthreads\ttime\tthroughput" << std::endl;
+    compare_loops();
+    compare<ms::Array<float, 4096, 4096>, 2>("4096x4096", max_threads);
+    compare<ms::Array<float, 256, 256, 256>, 3>("256x256x256", max_threads);
+    compare<ms::Array<float, 4, 4194304>, 2>("4x4194304", max_threads);
+}
@@ -0,0 +1,131 @@
+#include "arbitrary_dim_array.hpp"
+#include "array_snapshot.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Contention benchmark: 1 writer updating one outer slab per tick, N readers summing one row per read
+namespace {
+
+    typedef ms::Array<long, 256, 1024> Grid;
+
+    const std::size_t Slabs = 256;
+    const std::size_t Row = 1024;
+    const double Seconds = 1.0;
+
+    // Result of one benchmark run
+    struct Result {
+        double writes_per_second;
+        double reads_per_second;
+    };
+
+    // Sums one row of a grid, the unit of reader work
+    long read_row(const Grid &grid, std::size_t slab) {
+        long sum = 0;
+        for (std::size_t index = 0; index < Row; ++index) {
+            sum += grid[slab][index];
+        }
+        return sum;
+    }
+
+    // Readers and the writer share one array guarded by a mutex
+    Result run_mutex(std::size_t reader_count) {
+        Grid *grid = new Grid;
+        std::mutex lock;
+        std::atomic<bool> done{false};
+        std::atomic<long> reads{0};
+        std::atomic<long> sink{0};
+
+        std::vector<std::thread> readers;
+        for (std::size_t thread = 0; thread < reader_count; ++thread) {
+            readers.emplace_back([&, thread]() {
+                long local_reads = 0;
+                long local_sink = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    local_sink += read_row(*grid, (thread + local_reads) % Slabs);
+                    ++local_reads;
+                }
+                reads += local_reads;
+                sink += local_sink;
+            });
+        }
+
+        long writes = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < Seconds) {
+            std::lock_guard<std::mutex> guard(lock);
+            for (std::size_t index = 0; index < Row; ++index) {
+                (*grid)[writes % Slabs][index] = writes;
+            }
+            ++writes;
+        }
+        done.store(true);
+        for (std::size_t thread = 0; thread < readers.size(); ++thread) {
+            readers[thread].join();
+        }
+        delete grid;
+
+        Result result = {writes / Seconds, reads.load() / Seconds};
+        return result;
+    }
+
+    // Readers pin published versions of a SnapshotArray
+    Result run_snapshot(std::size_t reader_count) {
+        ms::SnapshotArray<long, 256, 1024> *grid = new ms::SnapshotArray<long, 256, 1024>(reader_count);
+        std::atomic<bool> done{false};
+        std::atomic<long> reads{0};
+        std::atomic<long> sink{0};
+
+        std::vector<std::thread> readers;
+        for (std::size_t thread = 0; thread < reader_count; ++thread) {
+            readers.emplace_back([&, thread]() {
+                ms::SnapshotArray<long, 256, 1024>::Reader reader(*grid);
+                long local_reads = 0;
+                long local_sink = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    ms::SnapshotArray<long, 256, 1024>::View view = reader.read();
+                    local_sink += read_row(*view, (thread + local_reads) % Slabs);
+                    ++local_reads;
+                }
+                reads += local_reads;
+                sink += local_sink;
+            });
+        }
+
+        long writes = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < Seconds) {
+            ms::Array<long, 1024> &slab = grid->write(writes % Slabs);
+            for (std::size_t index = 0; index < Row; ++index) {
+                slab[index] = writes;
+            }
+            grid->publish();
+            ++writes;
+        }
+        done.store(true);
+        for (std::size_t thread = 0; thread < readers.size(); ++thread) {
+            readers[thread].join();
+        }
+        delete grid;
+
+        Result result = {writes / Seconds, reads.load() / Seconds};
+        return result;
+    }
+}
+
+// Program to compare a mutex guarded Array with SnapshotArray under 1 writer and N readers
+int main(int argc, char **argv) {
+    std::size_t max_readers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+
+    std::cout << "readers\tmutex writes/s\tmutex reads/s\tsnapshot writes/s\tsnapshot reads/s" << std::endl;
+    for (std::size_t reader_count = 1; reader_count <= max_readers; reader_count *= 2) {
+        Result locked = run_mutex(reader_count);
+        Result snapshot = run_snapshot(reader_count);
+        std::cout << reader_count << "\t" << locked.writes_per_second << "\t" << locked.reads_per_second
+                  << "\t" << snapshot.writes_per_second << "\t" << snapshot.reads_per_second << std::endl;
+    }
+}